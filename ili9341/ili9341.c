@@ -27,7 +27,8 @@
 //      It implements boxy color plane which mimics Zx-Spectrum screen memory
 //  structure.
 //
-//      8x8 bitmap font is being used.
+//      8x8 bitmap font is being used. Text is UTF-8: the chars beyond ASCII
+//  are drawn by the extension font (fonts/ext_8x8.bdf).
 //
 //  PLATFORM
 //      Raspberry Pi pico.
@@ -61,6 +62,7 @@
 //  THE SOFTWARE.
 ///////////////////////////////////////////////////////////////////////////////
 #include "ili9341.h"
+#include "tft_font.h"
 
 static inline void ILI9341_CS_Set(const ili9341_config_t *pconfig, int state) 
 {
@@ -401,9 +403,71 @@ void TftPutChar(screen_control_t *pscr, int x, int y, int paper, int ink,
     *pbox |= (1<<6);        // Set for update.
 }
 
+/// @brief Draws a glyph of the extension font into 8x8 cell of 1bpp canvas.
+/// @brief The glyph is centered like the glyphs of kFONT_.
+/// @param pbuf Pixel buffer.
+/// @param bitpos Bit number of the top-left pixel of the cell.
+/// @param glyph Glyph index of kFONT_EXT_8x8.
+/// @param over Whether to clear the background of glyph.
+static void TftPutExtGlyph(uint32_t *pbuf, int bitpos, int glyph, bool over)
+{
+    const tft_font_t *pfont = &kFONT_EXT_8x8;
+    const tft_glyph_t *pglyph = pfont->mpGlyph + glyph;
+    const int shft = pglyph->mWidth < 9 ? (9 - pglyph->mWidth) >> 1 : 0;
+    const int row_beg = pglyph->mTop;
+    const int row_end = pglyph->mTop + pglyph->mRows;
+
+    tft_glyph_decoder_t dec;
+    TftGlyphDecodeStart(pfont, glyph, &dec);
+
+    for(int j = 0; j < 8; ++j, bitpos += PIX_WIDTH)
+    {
+        const uint32_t row = (j >= row_beg && j < row_end)
+                           ? (TftGlyphDecodeRow(&dec) >> shft) & 0xFF000000
+                           : 0;
+        TftMergeRow(pbuf, bitpos, row, 0xFF000000, over);
+    }
+}
+
+/// @brief Draws a char given by Unicode codepoint onto the screen buffer.
+/// @brief Printable ASCII is drawn by kFONT_, the rest by the extension font
+/// @brief kFONT_EXT_8x8 or its fallback glyph. Control chars are ignored.
+/// @param pscr Control structure.
+/// @param x X coord, 0...TEXT_WIDTH-1.
+/// @param y Y coord, 0...TEXT_HEIGHT-1.
+/// @param paper Paper color, 0..7.
+/// @param ink Ink color, 0..7.
+/// @param codepoint Unicode codepoint.
+void TftPutCodepoint(screen_control_t *pscr, int x, int y, int paper, int ink,
+                    uint32_t codepoint)
+{
+    if(codepoint < 0x80)
+    {
+        TftPutChar(pscr, x, y, paper, ink, (char)codepoint);
+        return;
+    }
+
+    const int glyph = codepoint < 0xA0 
+                    ? -1 : TftFontGlyph(&kFONT_EXT_8x8, codepoint);
+    if(glyph < 0)
+    {
+        return;
+    }
+
+    TftPutExtGlyph(pscr->mpPixBuffer, (y << 3) * PIX_WIDTH + (x << 3), glyph,
+                    true);
+
+    uint8_t *pbox = pscr->mpColorBuffer + x + TEXT_WIDTH * y;
+
+    *pbox &= 0b11000000;    // clear color attrs.
+    *pbox |= ink & 0b111;
+    *pbox |= (paper & 0b111) << 3;   
+    *pbox |= (1<<6);        // Set for update.
+}
+
 /// @brief Puts the null-terminated string onto the screen buffer.
 /// @param pscr Control structure.
-/// @param str Null-terminated string.
+/// @param str Null-terminated UTF-8 string.
 /// @param top_y Top symbol Y of scroll area.
 /// @param bot_y Top symbol X of scroll area.
 /// @param paper Paper color, [0..7].
@@ -415,6 +479,7 @@ void TftPutString(screen_control_t *pscr, const char* str,
     assert_(str);
     assert_(bot_y);
 
+    utf8_decoder_t utf8 = { 0 };
     for(int i = 0; str[i]; ++i)
     {
         if(pscr->mCursorY >= bot_y)
@@ -431,7 +496,24 @@ void TftPutString(screen_control_t *pscr, const char* str,
         }
         else
         {
-            TftPutChar(pscr, pscr->mCursorX, pscr->mCursorY, paper, ink, ch);
+            if(ch & 0x80)       // Byte of UTF-8 multibyte sequence.
+            {
+                const uint32_t codepoint = Utf8DecodeByte(&utf8, ch);
+                if(UTF8_PENDING == codepoint)
+                {
+                    continue;
+                }
+
+                TftPutCodepoint(pscr, pscr->mCursorX, pscr->mCursorY, paper,
+                                ink, codepoint);
+            }
+            else
+            {
+                utf8.mPending = 0;
+                TftPutChar(pscr, pscr->mCursorX, pscr->mCursorY, paper, ink,
+                            ch);
+            }
+
             if(++pscr->mCursorX >= TEXT_WIDTH)
             {
                 pscr->mCursorX = 0;
@@ -593,9 +675,10 @@ void TftPutLine(screen_control_t *pscr, int x0, int y0, int x1, int y1)
 /// @brief Puts a short text label on the screen buffer using the graphical
 /// @brief coordinate system. This is useful in widgets and menus.
 /// @param pscr Control structure.
-/// @param pstr Null terminated string.
+/// @param pstr Null terminated UTF-8 string.
 /// @param x_pix Top-left point of the first symbol X coord.
 /// @param y_pix Top-left point of the first symbol Y coord.
+/// @param over Whether to clear the background of glyphs.
 void TftPutTextLabel(screen_control_t *pscr, const char *pstr, int x_pix, 
                     int y_pix, bool over)
 {
@@ -608,9 +691,41 @@ void TftPutTextLabel(screen_control_t *pscr, const char *pstr, int x_pix,
     }
 
     int max_len = (PIX_WIDTH - x_pix) >> 3;
-    for(int s = 0; pstr[s] && max_len; ++s, --max_len)
+    utf8_decoder_t utf8 = { 0 };
+    for(int s = 0; pstr[s] && max_len; ++s)
     {
         char chr = pstr[s];
+        if(chr & 0x80)          // Byte of UTF-8 multibyte sequence.
+        {
+            const uint32_t codepoint = Utf8DecodeByte(&utf8, chr);
+            if(UTF8_PENDING == codepoint)
+            {
+                continue;
+            }
+
+            const int glyph = codepoint < 0xA0 
+                            ? -1 : TftFontGlyph(&kFONT_EXT_8x8, codepoint);
+            if(glyph < 0)
+            {
+                return;
+            }
+
+            TftPutExtGlyph(pscr->mpPixBuffer, y_pix * PIX_WIDTH + x_pix, glyph,
+                            over);
+
+            for(int by = y_pix >> 3; by <= (y_pix + 7) >> 3; ++by)
+            {
+                for(int bx = x_pix >> 3; bx <= (x_pix + 7) >> 3; ++bx)
+                {
+                    pscr->mpColorBuffer[bx + by * TEXT_WIDTH] |= 1 << 6;
+                }
+            }
+            x_pix += 8;
+            --max_len;
+            continue;
+        }
+
+        utf8.mPending = 0;
         if(chr > 0x7E || chr < 0x20)
         {
             return; // chr > '~'
@@ -639,6 +754,7 @@ void TftPutTextLabel(screen_control_t *pscr, const char *pstr, int x_pix,
             }
         }
         x_pix += 8;
+        --max_len;
     }
 }
 
@@ -26,7 +26,8 @@
 //      It implements boxy color plane which mimics Zx-Spectrum screen memory
 //  structure.
 //
-//      8x8 bitmap font is being used.
+//      8x8 bitmap font is being used. Text is UTF-8: the chars beyond ASCII
+//  are drawn by the extension font (fonts/ext_8x8.bdf).
 //
 //  PLATFORM
 //      Raspberry Pi pico.
@@ -149,6 +150,8 @@ void TftSetCursor(screen_control_t *pscr, int x, int y);
 
 void TftPutChar(screen_control_t *pscr, int x, int y, int paper, int ink, 
                 char chr);
+void TftPutCodepoint(screen_control_t *pscr, int x, int y, int paper, int ink,
+                    uint32_t codepoint);
 
 void TftPutColorAttr(screen_control_t *pscr, int x, int y, int paper, int ink);
 
@@ -0,0 +1,295 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  tft_font.c - Proportional font engine for the ILI9341 screen buffer.
+// 
+//
+//  DESCRIPTION
+//
+//      Glyph rows of a packed proportional font are placed at an arbitrary
+//  pixel position of the 1bpp canvas using shift-and-merge: a left-aligned
+//  row is shifted into the 32-bit word(s) of the canvas it covers and OR-ed
+//  (or masked and OR-ed in overwrite mode), so no per-pixel loops are
+//  involved. Only the 8x8 blocks actually touched by a glyph are set for
+//  update, hence narrow labels cost fewer blocks to flush.
+//
+//      Glyph rows are decoded on the fly (see tft_font.h), no glyph is ever
+//  unpacked into RAM.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+// 
+//      Rev 0.1   17 Oct 2026
+//  Initial release.
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2026 by Roman Piksaykin
+//  
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "tft_font.h"
+
+/// @brief Sets up the decoding of glyph rows.
+/// @param pfont Font.
+/// @param glyph Glyph index.
+/// @param pdec Decoder state.
+void TftGlyphDecodeStart(const tft_font_t *pfont, int glyph,
+                        tft_glyph_decoder_t *pdec)
+{
+    assert_(pfont);
+    assert_(pdec);
+
+    const tft_glyph_t *pglyph = pfont->mpGlyph + glyph;
+
+    pdec->mpData = pfont->mpData + pglyph->mOffset;
+    pdec->mBytes = pglyph->mWidth ? (pglyph->mWidth + 7) >> 3 : 1;
+
+    if(pfont->mFlags & TFT_FONT_RLE)
+    {
+        pdec->mRun = 0;             // Control byte goes first.
+    }
+    else
+    {
+        pdec->mRun = pglyph->mRows; // All the rows are literal.
+        pdec->mRepeat = false;
+    }
+}
+
+/// @brief Looks for the glyph of a codepoint beyond directly indexed ones.
+/// @param pfont Font.
+/// @param codepoint Unicode codepoint.
+/// @return Glyph index, -1 if the font has neither the glyph nor fallback.
+int TftFontGlyphSparse(const tft_font_t *pfont, uint32_t codepoint)
+{
+    assert_(pfont);
+
+    int lo = 0, hi = pfont->mRangeCount - 1;
+    while(lo <= hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        const tft_font_range_t *prange = pfont->mpRange + mid;
+        if(codepoint < prange->mFirst)
+        {
+            hi = mid - 1;
+        }
+        else if(codepoint >= (uint32_t)prange->mFirst + prange->mCount)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            return prange->mGlyph + (codepoint - prange->mFirst);
+        }
+    }
+
+    return TFT_FONT_NO_GLYPH == pfont->mFallback ? -1 : pfont->mFallback;
+}
+
+/// @brief Looks for the kerning value of the pair of glyphs.
+/// @param pfont Font.
+/// @param left Left glyph index.
+/// @param right Right glyph index.
+/// @return Advance correction in pixels, 0 if the pair isn't kerned.
+int TftFontKerning(const tft_font_t *pfont, int left, int right)
+{
+    assert_(pfont);
+
+    const uint32_t key = ((uint32_t)left << 16) | (uint32_t)right;
+
+    int lo = 0, hi = pfont->mKernCount - 1;
+    while(lo <= hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        const uint32_t pair = pfont->mpKernPair[mid];
+        if(pair == key)
+        {
+            return pfont->mpKernValue[mid];
+        }
+
+        if(pair < key)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+
+    return 0;
+}
+
+/// @brief Calculates the width of the text drawn by a proportional font.
+/// @param pfont Font.
+/// @param pstr Null terminated UTF-8 string.
+/// @return Width of the text in pixels, without trailing spacing.
+int TftMeasurePropText(const tft_font_t *pfont, const char *pstr)
+{
+    assert_(pfont);
+    assert_(pstr);
+
+    int x_pix = 0, width = 0;
+    int prev = -1;
+    utf8_decoder_t utf8 = { 0 };
+    for(int s = 0; pstr[s]; ++s)
+    {
+        const uint32_t codepoint = Utf8DecodeByte(&utf8, pstr[s]);
+        if(UTF8_PENDING == codepoint)
+        {
+            continue;
+        }
+
+        const int glyph = TftFontGlyph(pfont, codepoint);
+        if(glyph < 0 || codepoint < 0x20)
+        {
+            break;
+        }
+
+        if(prev >= 0)
+        {
+            x_pix += TftFontKerning(pfont, prev, glyph);
+        }
+        prev = glyph;
+
+        width = x_pix + pfont->mpGlyph[glyph].mWidth;
+        x_pix += pfont->mpGlyph[glyph].mAdvance;
+    }
+
+    return width;
+}
+
+/// @brief Puts a text label drawn by a proportional font on the screen buffer
+/// @brief using the graphical coordinate system. The label is truncated by
+/// @brief the right edge of the screen, by a control char or by the first
+/// @brief char absent in a font having no fallback glyph.
+/// @param pscr Control structure.
+/// @param pfont Font.
+/// @param pstr Null terminated UTF-8 string.
+/// @param x_pix Top-left point of the first symbol X coord.
+/// @param y_pix Top-left point of the first symbol Y coord.
+/// @param over Whether to clear the background of glyphs.
+/// @return Pen advance in pixels (the X coord of next label is x_pix + ret).
+int TftPutPropText(screen_control_t *pscr, const tft_font_t *pfont, 
+                    const char *pstr, int x_pix, int y_pix, bool over)
+{
+    assert_(pscr);
+    assert_(pfont);
+    assert_(pstr);
+
+    if(x_pix < 0 || y_pix < 0 || y_pix > PIX_HEIGHT - pfont->mHeight)
+    {
+        return 0;
+    }
+
+    const int x_start = x_pix;
+    const int blk_top = y_pix >> 3;
+    const int blk_bot = (y_pix + pfont->mHeight - 1) >> 3;
+
+    int prev = -1;
+    utf8_decoder_t utf8 = { 0 };
+    for(int s = 0; pstr[s]; ++s)
+    {
+        const uint32_t codepoint = Utf8DecodeByte(&utf8, pstr[s]);
+        if(UTF8_PENDING == codepoint)
+        {
+            continue;
+        }
+
+        const int glyph = TftFontGlyph(pfont, codepoint);
+        if(glyph < 0 || codepoint < 0x20)
+        {
+            break;
+        }
+
+        if(prev >= 0)
+        {
+            x_pix += TftFontKerning(pfont, prev, glyph);
+        }
+        prev = glyph;
+
+        const tft_glyph_t *pglyph = pfont->mpGlyph + glyph;
+        if(x_pix + pglyph->mWidth > PIX_WIDTH)
+        {
+            break;
+        }
+
+        // In overwrite mode the spacing after glyph is cleared too.
+        int cover = pglyph->mWidth;
+        if(over && pglyph->mAdvance > cover)
+        {
+            cover = pglyph->mAdvance;
+        }
+        if(cover > 32)
+        {
+            cover = 32;
+        }
+        if(x_pix + cover > PIX_WIDTH)
+        {
+            cover = PIX_WIDTH - x_pix;
+        }
+
+        if(cover)
+        {
+            const uint32_t mask = 0xFFFFFFFFu << (32 - cover);
+            const int row_beg = pglyph->mTop;
+            const int row_end = pglyph->mTop + pglyph->mRows;
+
+            tft_glyph_decoder_t dec;
+            TftGlyphDecodeStart(pfont, glyph, &dec);
+
+            int bitpos = y_pix * PIX_WIDTH + x_pix;
+            for(int j = 0; j < pfont->mHeight; ++j, bitpos += PIX_WIDTH)
+            {
+                if(j >= row_beg && j < row_end)
+                {
+                    TftMergeRow(pscr->mpPixBuffer, bitpos, 
+                                TftGlyphDecodeRow(&dec), mask, over);
+                }
+                else if(over)
+                {
+                    TftMergeRow(pscr->mpPixBuffer, bitpos, 0, mask, true);
+                }
+            }
+
+            const int blk_left = x_pix >> 3;
+            const int blk_right = (x_pix + cover - 1) >> 3;
+            for(int by = blk_top; by <= blk_bot; ++by)
+            {
+                uint8_t *pbox = pscr->mpColorBuffer + by * TEXT_WIDTH;
+                for(int bx = blk_left; bx <= blk_right; ++bx)
+                {
+                    pbox[bx] |= 1 << 6;     // Set for update.
+                }
+            }
+        }
+
+        x_pix += pglyph->mAdvance;
+    }
+
+    return x_pix - x_start;
+}
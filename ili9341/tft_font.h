@@ -0,0 +1,233 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  tft_font.h - Proportional font engine for the ILI9341 screen buffer.
+// 
+//
+//  DESCRIPTION
+//
+//      The engine draws text using packed proportional fonts: every glyph has
+//  its own width and pen advance, so a label is as wide as its ink plus the
+//  inter-glyph spacing rather than 8 pixels per symbol. Optional kerning
+//  pairs move selected glyph pairs closer.
+//
+//      Fonts are generated at build time by tools/fontgen.py, either from the
+//  kFONT_ table of font_8x8.h or from BDF fonts of any size (glyphs up to 32
+//  pixels wide). Each glyph is cropped to its inked rows and is described by
+//  an index entry; the rows are stored raw or run-length encoded. Decoding a
+//  row costs one load of the row bytes (or nothing for a repeated row), so
+//  compressed fonts draw as fast as raw ones.
+//
+//      Text is UTF-8. Glyphs of a contiguous codepoint range (printable
+//  ASCII) are indexed directly, the others are found by binary search in a
+//  sorted table of codepoint ranges; absent codepoints are drawn with the
+//  fallback glyph of the font.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+// 
+//      Rev 0.1   17 Oct 2026
+//  Initial release.
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2026 by Roman Piksaykin
+//  
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _TFT_FONT_H
+#define _TFT_FONT_H
+
+#include <stdint.h>
+
+#include "ili9341.h"
+#include "tft_utf8.h"
+
+#define TFT_FONT_RLE        0x01    // Glyph rows are run-length encoded.
+#define TFT_FONT_NO_GLYPH   0xFFFF  // Font has no fallback glyph.
+
+/// @brief Glyph index entry.
+typedef struct
+{
+    uint16_t mOffset;               // Offset of glyph data in font's mpData.
+    uint8_t mWidth;                 // Glyph width, pixels [0..32].
+    uint8_t mAdvance;               // Pen advance, pixels.
+    uint8_t mTop;                   // Blank rows above the stored ones.
+    uint8_t mRows;                  // Number of stored rows.
+
+} tft_glyph_t;
+
+/// @brief Codepoints indexed by the range table.
+typedef struct
+{
+    uint16_t mFirst;                // First codepoint of the range.
+    uint16_t mCount;                // Number of codepoints.
+    uint16_t mGlyph;                // Glyph index of the first codepoint.
+
+} tft_font_range_t;
+
+/// @brief Packed proportional font.
+typedef struct
+{
+    uint8_t mHeight;                // Glyph cell height, pixels.
+    uint8_t mFlags;                 // TFT_FONT_xxx.
+    uint16_t mFirstChar;            // Codepoint of the first glyph.
+    uint16_t mDirectCount;          // Glyphs indexed directly from the first.
+    uint16_t mGlyphCount;           // Number of glyphs.
+    uint16_t mFallback;             // Glyph for codepoints absent in font.
+
+    const tft_glyph_t *mpGlyph;     // Glyph index.
+    const uint8_t *mpData;          // Glyph rows of (mWidth + 7) / 8 bytes,
+                                    // leftmost pixel is the MSB. If the font
+                                    // is TFT_FONT_RLE, a control byte 0RRRRRRR
+                                    // precedes R+1 literal rows and a byte
+                                    // 1RRRRRRR precedes a row repeated R+1
+                                    // times.
+
+    uint16_t mRangeCount;           // Sorted codepoint ranges beyond the
+    const tft_font_range_t *mpRange;// directly indexed ones.
+
+    uint16_t mKernCount;            // Size of the kerning tables.
+    const uint32_t *mpKernPair;     // Sorted glyph index pairs
+                                    // (left << 16 | right).
+    const int8_t *mpKernValue;      // Advance correction of a pair, pixels.
+
+} tft_font_t;
+
+/// @brief State of glyph rows decoding.
+typedef struct
+{
+    const uint8_t *mpData;          // Next byte of glyph data.
+    uint8_t mBytes;                 // Bytes per row.
+    uint8_t mRun;                   // Rows left in current run.
+    bool mRepeat;                   // Current run repeats one row.
+    uint32_t mRow;                  // Last row decoded, leftmost pixel is MSB.
+
+} tft_glyph_decoder_t;
+
+extern const tft_font_t kFONT_PROP_8x8;
+extern const tft_font_t kFONT_EXT_8x8;
+
+int TftFontGlyphSparse(const tft_font_t *pfont, uint32_t codepoint);
+
+/// @brief Looks for the glyph of a codepoint.
+/// @param pfont Font.
+/// @param codepoint Unicode codepoint.
+/// @return Glyph index, -1 if the font has neither the glyph nor fallback.
+static inline int TftFontGlyph(const tft_font_t *pfont, uint32_t codepoint)
+{
+    const uint32_t direct = codepoint - pfont->mFirstChar;
+    if(direct < pfont->mDirectCount)
+    {
+        return direct;
+    }
+
+    return TftFontGlyphSparse(pfont, codepoint);
+}
+
+/// @brief Merges a left-aligned row of pixels into 1bpp canvas.
+/// @param pbuf Pixel buffer.
+/// @param bitpos Bit number of the leftmost pixel of the row.
+/// @param bits Pixels to set, leftmost pixel is the MSB.
+/// @param mask Pixels affected by the row, leftmost pixel is the MSB.
+/// @param over Whether to clear the masked pixels not set in `bits`.
+static inline void TftMergeRow(uint32_t *pbuf, int bitpos, uint32_t bits,
+                                uint32_t mask, bool over)
+{
+    uint32_t *pw = pbuf + (bitpos >> 5);
+    const int shft = bitpos & 31;
+
+    if(over)
+    {
+        pw[0] &= ~(mask >> shft);
+    }
+    pw[0] |= bits >> shft;
+
+    if(shft && (mask << (32 - shft)))   // The row spills to the next word.
+    {
+        if(over)
+        {
+            pw[1] &= ~(mask << (32 - shft));
+        }
+        pw[1] |= bits << (32 - shft);
+    }
+}
+
+void TftGlyphDecodeStart(const tft_font_t *pfont, int glyph,
+                        tft_glyph_decoder_t *pdec);
+
+/// @brief Reads a glyph row of 1..4 bytes.
+/// @param pdata Row bytes.
+/// @param bytes Number of bytes.
+/// @return The row, leftmost pixel is the MSB.
+static inline uint32_t TftGlyphReadRow(const uint8_t *pdata, int bytes)
+{
+    uint32_t row = (uint32_t)pdata[0] << 24;
+    switch(bytes)
+    {
+        case 4: row |= pdata[3];                    // Fall through.
+        case 3: row |= (uint32_t)pdata[2] << 8;     // Fall through.
+        case 2: row |= (uint32_t)pdata[1] << 16;
+    }
+    return row;
+}
+
+/// @brief Decodes next stored row of the glyph.
+/// @param pdec Decoder state set up by TftGlyphDecodeStart.
+/// @return The row, leftmost pixel is the MSB.
+static inline uint32_t TftGlyphDecodeRow(tft_glyph_decoder_t *pdec)
+{
+    if(!pdec->mRun)                 // Next RLE control byte.
+    {
+        const uint8_t ctl = *pdec->mpData++;
+        pdec->mRun = (ctl & 0x7F) + 1;
+        pdec->mRepeat = ctl >> 7;
+        if(pdec->mRepeat)
+        {
+            pdec->mRow = TftGlyphReadRow(pdec->mpData, pdec->mBytes);
+            pdec->mpData += pdec->mBytes;
+        }
+    }
+
+    --pdec->mRun;
+    if(!pdec->mRepeat)
+    {
+        pdec->mRow = TftGlyphReadRow(pdec->mpData, pdec->mBytes);
+        pdec->mpData += pdec->mBytes;
+    }
+
+    return pdec->mRow;
+}
+
+int TftFontKerning(const tft_font_t *pfont, int left, int right);
+
+int TftMeasurePropText(const tft_font_t *pfont, const char *pstr);
+
+int TftPutPropText(screen_control_t *pscr, const tft_font_t *pfont, 
+                    const char *pstr, int x_pix, int y_pix, bool over);
+
+#endif
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  tft_utf8.h - UTF-8 decoding of the text put on the screen buffer.
+// 
+//
+//  DESCRIPTION
+//
+//      A tiny byte-driven UTF-8 decoder. It keeps its state between calls, so it
+//  serves both null-terminated strings and streams of chars such as the
+//  output of formatters. ASCII bytes pass through at the cost of a single
+//  test.
+//
+//  PLATFORM
+//      The code is platform-independent.
+//
+//  REVISION HISTORY
+// 
+//      Rev 0.1   17 Oct 2026
+//  Initial release.
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2026 by Roman Piksaykin
+//  
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef _TFT_UTF8_H
+#define _TFT_UTF8_H
+
+#include <stdint.h>
+
+#define UTF8_PENDING        0xFFFFFFFFu // More bytes of sequence are needed.
+#define UTF8_REPLACEMENT    0xFFFDu     // Codepoint of a malformed sequence.
+
+/// @brief State of UTF-8 decoding.
+typedef struct
+{
+    uint32_t mCodepoint;                // Codepoint being assembled.
+    uint8_t mPending;                   // Continuation bytes awaited.
+
+} utf8_decoder_t;
+
+/// @brief Feeds a byte to UTF-8 decoder. A truncated sequence followed by
+/// @brief a new one is dropped.
+/// @param pdec Decoder state, zero-initialized before the first byte.
+/// @param byte Next byte of text.
+/// @return Decoded codepoint or UTF8_PENDING.
+static inline uint32_t Utf8DecodeByte(utf8_decoder_t *pdec, uint8_t byte)
+{
+    if(byte < 0x80)
+    {
+        pdec->mPending = 0;
+        return byte;
+    }
+
+    if((byte & 0xC0) == 0x80)           // Continuation byte.
+    {
+        if(!pdec->mPending)
+        {
+            return UTF8_REPLACEMENT;
+        }
+
+        pdec->mCodepoint = (pdec->mCodepoint << 6) | (byte & 0x3F);
+        return --pdec->mPending ? UTF8_PENDING : pdec->mCodepoint;
+    }
+
+    if((byte & 0xE0) == 0xC0)
+    {
+        pdec->mCodepoint = byte & 0x1F;
+        pdec->mPending = 1;
+    }
+    else if((byte & 0xF0) == 0xE0)
+    {
+        pdec->mCodepoint = byte & 0x0F;
+        pdec->mPending = 2;
+    }
+    else if((byte & 0xF8) == 0xF0)
+    {
+        pdec->mCodepoint = byte & 0x07;
+        pdec->mPending = 3;
+    }
+    else
+    {
+        pdec->mPending = 0;
+        return UTF8_REPLACEMENT;
+    }
+
+    return UTF8_PENDING;
+}
+
+#endif
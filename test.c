@@ -2,6 +2,7 @@
 #include <stdlib.h>
 
 #include "ili9341/ili9341.h"
+#include "ili9341/tft_font.h"
 #include "touch/msp2807_touch.h"
 
 // TODO: PSE uncomment one mode only.
@@ -10,6 +11,11 @@
 #define MODE_TEST_TOUCH_DRAWING
 //#define MODE_TEST_RANDOM_LINES
 //#define MODE_TEST_RANDOM_LABELS
+//#define MODE_TEST_RANDOM_PROP_LABELS
+//#define MODE_BENCH_FONT_DECODE
+//#define MODE_BENCH_TEXT_UTF8
+
+extern const tft_font_t kFONT_PROP_8x8_RLE;
 
 void PRN32(uint32_t *val)
 { 
@@ -55,6 +61,22 @@ void TestRandomLabels(screen_control_t *p_screen)
     TftFullScreenSelectiveWrite(p_screen, 10000);
 }
 
+void TestRandomPropLabels(screen_control_t *p_screen)
+{
+    assert_(p_screen);
+
+    static uint32_t rnd_seed = 0xa5efddbd;
+
+    PRN32(&rnd_seed);
+    const int x = rnd_seed % 240;
+    PRN32(&rnd_seed);
+    const int y = rnd_seed % 312;
+
+    TftPutPropText(p_screen, &kFONT_PROP_8x8, "Pico RULEZZ", x, y, false);
+    
+    TftFullScreenSelectiveWrite(p_screen, 10000);
+}
+
 void TestRandomLines(screen_control_t *p_screen)
 {
     assert_(p_screen);
@@ -75,6 +97,140 @@ void TestRandomLines(screen_control_t *p_screen)
     TftFullScreenSelectiveWrite(p_screen, 10000);
 }
 
+void BenchFontDecodeRows(const tft_font_t *pfont, volatile uint32_t *psink)
+{
+    for(int g = 0; g < pfont->mGlyphCount; ++g)
+    {
+        tft_glyph_decoder_t dec;
+        TftGlyphDecodeStart(pfont, g, &dec);
+        for(int j = 0; j < pfont->mpGlyph[g].mRows; ++j)
+        {
+            *psink ^= TftGlyphDecodeRow(&dec);
+        }
+    }
+}
+
+void BenchFontDecode(void)
+{
+    const int kpasses = 1000;
+    volatile uint32_t sink = 0;
+
+    uint64_t tm0 = time_us_64();
+    for(int p = 0; p < kpasses; ++p)
+    {
+        for(int i = 2; i < 2 + 95 * 8; ++i)
+        {
+            sink ^= kFONT_[i];
+        }
+    }
+    
+    uint64_t tm1 = time_us_64();
+    for(int p = 0; p < kpasses; ++p)
+    {
+        BenchFontDecodeRows(&kFONT_PROP_8x8, &sink);
+    }
+
+    uint64_t tm2 = time_us_64();
+    for(int p = 0; p < kpasses; ++p)
+    {
+        BenchFontDecodeRows(&kFONT_PROP_8x8_RLE, &sink);
+    }
+
+    uint64_t tm3 = time_us_64();
+    printf("Font rows x%d: kFONT_ %u us, raw %u us, RLE %u us\n", kpasses,
+            (unsigned)(tm1 - tm0), (unsigned)(tm2 - tm1), (unsigned)(tm3 - tm2));
+}
+
+/// @brief TftPutString loop as it was before UTF-8 support. It is the
+/// @brief reference of ASCII throughput.
+void PutStringAsciiRef(screen_control_t *pscr, const char* str, 
+                        int top_y, int bot_y, int paper, int ink)
+{
+    for(int i = 0; str[i]; ++i)
+    {
+        if(pscr->mCursorY >= bot_y)
+        {
+            TftScrollVerticalZone(pscr, top_y, bot_y);
+            --pscr->mCursorY;
+        }
+
+        const char ch = str[i];
+        if('\n' == ch || '\r' == ch)
+        {
+            pscr->mCursorX = 0;
+            ++pscr->mCursorY;
+        }
+        else
+        {
+            TftPutChar(pscr, pscr->mCursorX, pscr->mCursorY, paper, ink, ch);
+            if(++pscr->mCursorX >= TEXT_WIDTH)
+            {
+                pscr->mCursorX = 0;
+                ++pscr->mCursorY;
+            }
+        }
+    }
+}
+
+void BenchTextUtf8(screen_control_t *p_screen)
+{
+    const int kpasses = 20;
+    const int klines = TEXT_HEIGHT;
+    const char *kascii = "The quick brown fox jumps 0123";      // 30 chars.
+    const char *kutf8 = "Съешь же ещё этих булок 25.0°C";       // 30 chars.
+
+    uint64_t tm[5];
+    tm[0] = time_us_64();
+    for(int p = 0; p < kpasses; ++p)
+    {
+        TftSetCursor(p_screen, 0, 0);
+        for(int l = 0; l < klines; ++l)
+        {
+            PutStringAsciiRef(p_screen, kascii, 0, TEXT_HEIGHT, kBlack, kWhite);
+        }
+    }
+
+    tm[1] = time_us_64();
+    for(int p = 0; p < kpasses; ++p)
+    {
+        TftSetCursor(p_screen, 0, 0);
+        for(int l = 0; l < klines; ++l)
+        {
+            TftPutString(p_screen, kascii, 0, TEXT_HEIGHT, kBlack, kWhite);
+        }
+    }
+
+    tm[2] = time_us_64();
+    for(int p = 0; p < kpasses; ++p)
+    {
+        TftSetCursor(p_screen, 0, 0);
+        for(int l = 0; l < klines; ++l)
+        {
+            TftPutString(p_screen, kutf8, 0, TEXT_HEIGHT, kBlack, kWhite);
+        }
+    }
+
+    tm[3] = time_us_64();
+    for(int p = 0; p < kpasses; ++p)
+    {
+        for(int l = 0; l < klines; ++l)
+        {
+            TftPutTextLabel(p_screen, kascii, 0, l << 3, true);
+        }
+    }
+
+    tm[4] = time_us_64();
+
+    const uint64_t kchars = (uint64_t)kpasses * klines * 30;
+    printf("Chars/s: ASCII ref %u, ASCII %u, UTF-8 %u, label ASCII %u\n",
+            (unsigned)(kchars * 1000000 / (tm[1] - tm[0])),
+            (unsigned)(kchars * 1000000 / (tm[2] - tm[1])),
+            (unsigned)(kchars * 1000000 / (tm[3] - tm[2])),
+            (unsigned)(kchars * 1000000 / (tm[4] - tm[3])));
+
+    TftFullScreenSelectiveWrite(p_screen, 10000);
+}
+
 int main() 
 {
     gpio_init(PICO_DEFAULT_LED_PIN);
@@ -84,6 +240,10 @@ int main()
     sleep_ms(250);
     gpio_put(PICO_DEFAULT_LED_PIN, 0);
 
+#if defined(MODE_BENCH_FONT_DECODE) || defined(MODE_BENCH_TEXT_UTF8)
+    stdio_init_all();
+#endif
+
     static screen_control_t sScreen =
     {
         .mCursorX = 0,
@@ -183,6 +343,20 @@ int main()
         //sleep_ms(250);
         continue;
 #endif
+#ifdef MODE_BENCH_FONT_DECODE
+        BenchFontDecode();
+        sleep_ms(1000);
+        continue;
+#endif
+#ifdef MODE_BENCH_TEXT_UTF8
+        BenchTextUtf8(&sScreen);
+        sleep_ms(1000);
+        continue;
+#endif
+#ifdef MODE_TEST_RANDOM_PROP_LABELS
+        TestRandomPropLabels(&sScreen);
+        continue;
+#endif
 
 #ifdef MODE_TEST_TOUCH_DRAWING
         CheckTouch(&touch_config);
@@ -0,0 +1,422 @@
+#!/usr/bin/env python3
+###############################################################################
+#
+#  fontgen.py - build-time font table generator for the ILI9341 library.
+#
+#  DESCRIPTION
+#
+#      Converts a bitmap font into the packed format of tft_font.h and emits
+#  it as a C source file holding `const` data only, which the linker places
+#  in flash. Two kinds of input are understood:
+#
+#  - the hand-maintained monospace font (kFONT_ in font_8x8.h). The glyph
+#    rows are stripped of the centering shift and the per-glyph width is
+#    taken from the `Width:` comments;
+#  - Glyph Bitmap Distribution Format fonts (*.bdf) of any size.
+#
+#  Several sources of the same height may be merged, the first source
+#  providing a codepoint wins.
+#
+#      Glyphs of a contiguous codepoint range (printable ASCII by default)
+#  are indexed directly; any other glyphs are found through a sorted table of
+#  codepoint ranges. A fallback glyph may be named for absent codepoints.
+#
+#      Every glyph is cropped to the rows holding ink and is described by an
+#  index entry (data offset, width, advance, top row, row count). Glyph rows
+#  are stored as 1..4 bytes, leftmost pixel in MSB. With --rle the rows are
+#  run-length encoded: a control byte 0RRRRRRR is followed by R+1 literal
+#  rows, a control byte 1RRRRRRR is followed by one row repeated R+1 times.
+#  Kerning pairs may be computed from glyph outlines.
+#
+#  LICENCE
+#      MIT License (http://www.opensource.org/licenses/mit-license.php)
+#
+###############################################################################
+import argparse
+import os
+import re
+import string
+import sys
+
+GLYPH_RE = re.compile(
+    r'/\*Unicode: U\+([0-9a-fA-F]{4}) \((.)\) , Width: (\d+) \*/\s*'
+    r'((?:0x[0-9a-fA-F]{2}(?:>>\d)?,?\s*//[^\n]*\n\s*){8})')
+ROW_RE = re.compile(r'0x([0-9a-fA-F]{2})(?:>>(\d))?')
+
+DEFAULT_KERN_SET = string.ascii_letters + string.digits + '.,'
+
+MAX_WIDTH = 32                          # A glyph row is at most 32 pixels.
+MAX_RUN = 128                           # Rows per RLE control byte.
+
+
+class Glyph:
+    def __init__(self, code, width, advance, rows):
+        self.code = code        # Unicode codepoint.
+        self.width = width      # Glyph width, pixels.
+        self.advance = advance  # Pen advance, pixels.
+        self.rows = rows        # Cell rows, leftmost pixel is bit width-1.
+
+    def extents(self):
+        """Leftmost & rightmost inked column of every row (None if blank)."""
+        left, right = [], []
+        for r in self.rows:
+            cols = [c for c in range(self.width)
+                    if (r >> (self.width - 1 - c)) & 1]
+            left.append(cols[0] if cols else None)
+            right.append(cols[-1] if cols else None)
+        return left, right
+
+
+def parse_font_8x8(path, spacing):
+    """Reads the kFONT_ glyphs of font_8x8.h. Returns (height, glyphs)."""
+    src = open(path, encoding='utf-8').read()
+    cut = src.find('#if 0')             # Tail of the file is disabled.
+    if cut >= 0:
+        src = src[:cut]
+
+    glyphs = []
+    for code, _, width, body in GLYPH_RE.findall(src):
+        width = int(width)
+        rows = []
+        for value, _ in ROW_RE.findall(body):
+            # The `>>n` shift only centers the glyph in the 8x8 cell; the
+            # unshifted value is the left-aligned row we need.
+            value = int(value, 16)
+            if value & ((1 << (8 - width)) - 1):
+                sys.exit('fontgen: U+%s is wider than its Width: %d'
+                         % (code, width))
+            rows.append(value >> (8 - width))
+        glyphs.append(Glyph(int(code, 16), width, width + spacing, rows))
+
+    return 8, glyphs
+
+
+def parse_bdf(path):
+    """Reads a BDF font. Returns (height, glyphs)."""
+    ascent = descent = None
+    bbox = None
+    glyphs = []
+    lines = iter(open(path, encoding='latin-1').read().splitlines())
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        if words[0] == 'FONTBOUNDINGBOX':
+            bbox = [int(v) for v in words[1:5]]
+        elif words[0] == 'FONT_ASCENT':
+            ascent = int(words[1])
+        elif words[0] == 'FONT_DESCENT':
+            descent = int(words[1])
+        elif words[0] == 'STARTCHAR':
+            code, dwidth, bbx, bitmap = -1, None, None, []
+            for line in lines:
+                words = line.split()
+                if not words:
+                    continue
+                if words[0] == 'ENCODING':
+                    code = int(words[-1])
+                elif words[0] == 'DWIDTH':
+                    dwidth = int(words[1])
+                elif words[0] == 'BBX':
+                    bbx = [int(v) for v in words[1:5]]
+                elif words[0] == 'BITMAP':
+                    for line in lines:
+                        if line.strip() == 'ENDCHAR':
+                            break
+                        bitmap.append(line.strip())
+                    break
+            if code >= 0 and bbx is not None:
+                glyphs.append((code, dwidth, bbx, bitmap))
+
+    if ascent is None or descent is None:
+        if bbox is None:
+            sys.exit('fontgen: %s: no font metrics' % path)
+        ascent, descent = bbox[1] + bbox[3], -bbox[3]
+    height = ascent + descent
+
+    result = []
+    for code, dwidth, (w, h, xoff, yoff), bitmap in glyphs:
+        xoff = max(xoff, 0)             # Glyphs do not overhang leftwards.
+        width = xoff + w
+        if width > MAX_WIDTH:
+            sys.exit('fontgen: %s: U+%04X is wider than %d pixels'
+                     % (path, code, MAX_WIDTH))
+        rows = [0] * height
+        top = ascent - (yoff + h)
+        for j, hexrow in enumerate(bitmap[:h]):
+            y = top + j
+            if not 0 <= y < height or not hexrow:
+                continue
+            bits = int(hexrow, 16) >> (len(hexrow) * 4 - w)
+            rows[y] = bits << (width - xoff - w)
+        advance = dwidth if dwidth is not None else width + 1
+        result.append(Glyph(code, width, advance, rows))
+
+    return height, result
+
+
+def select_glyphs(glyphs, direct, extra):
+    """Glyphs of the direct range (missing codes become blank glyphs)
+    followed by the sorted extra glyphs. Returns (glyphs, ranges) where
+    ranges are (first codepoint, count, first glyph) of the extra ones."""
+    by_code = {g.code: g for g in glyphs}
+    height = len(glyphs[0].rows) if glyphs else 0
+    blank_advance = by_code[0x20].advance if 0x20 in by_code else 1
+
+    out = []
+    if direct:
+        for code in range(direct[0], direct[1] + 1):
+            g = by_code.get(code)
+            out.append(g if g else Glyph(code, 0, blank_advance, [0] * height))
+
+    if extra == 'all':
+        codes = sorted(by_code)
+    else:
+        codes = sorted(extra)
+        for code in codes:
+            if code not in by_code:
+                sys.exit('fontgen: no glyph for U+%04X' % code)
+    if direct:
+        codes = [c for c in codes if not direct[0] <= c <= direct[1]]
+
+    ranges = []
+    for code in codes:
+        if code > 0xFFFF:
+            sys.exit('fontgen: U+%04X is beyond the BMP' % code)
+        if ranges and ranges[-1][0] + ranges[-1][1] == code:
+            ranges[-1][1] += 1
+        else:
+            ranges.append([code, 1, len(out)])
+        out.append(by_code[code])
+
+    return out, ranges
+
+
+def compute_kerning(glyphs, kern_set):
+    """Pairs which may be moved 1px closer keeping a blank pixel between
+    their ink, diagonal neighbours included. Returns (left, right, value)
+    tuples of glyph indices."""
+    pairs = []
+    prof = [g.extents() for g in glyphs]
+    for ia, a in enumerate(glyphs):
+        if chr(a.code) not in kern_set:
+            continue
+        _, right_a = prof[ia]
+        for ib, b in enumerate(glyphs):
+            if chr(b.code) not in kern_set:
+                continue
+            left_b, _ = prof[ib]
+            gap = None
+            for r in range(len(a.rows)):
+                if right_a[r] is None:
+                    continue
+                for rr in (r - 1, r, r + 1):
+                    if 0 <= rr < len(b.rows) and left_b[rr] is not None:
+                        g = a.advance + left_b[rr] - right_a[r] - 1
+                        gap = g if gap is None else min(gap, g)
+            if gap is not None and gap >= 2:
+                pairs.append((ia, ib, -1))
+    return pairs
+
+
+def row_bytes(width, row):
+    nbytes = max((width + 7) >> 3, 1)
+    value = row << (nbytes * 8 - width)
+    return [(value >> (8 * (nbytes - 1 - i))) & 0xFF for i in range(nbytes)]
+
+
+def encode_rows(width, rows, rle):
+    """Returns the glyph data bytes of stored rows."""
+    if not rle:
+        return [b for r in rows for b in row_bytes(width, r)]
+
+    # A repeat token pays off from 2 rows if a row takes several bytes.
+    min_repeat = 3 if width <= 8 else 2
+    data, literal = [], []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_RUN]
+            del literal[:MAX_RUN]
+            data.append(len(chunk) - 1)
+            for r in chunk:
+                data.extend(row_bytes(width, r))
+
+    i = 0
+    while i < len(rows):
+        run = 1
+        while i + run < len(rows) and rows[i + run] == rows[i]:
+            run += 1
+        if run >= min_repeat:
+            flush_literal()
+            left = run
+            while left:
+                n = min(left, MAX_RUN)
+                data.append(0x80 | (n - 1))
+                data.extend(row_bytes(width, rows[i]))
+                left -= n
+        else:
+            literal.extend(rows[i:i + run])
+        i += run
+    flush_literal()
+    return data
+
+
+def c_comment_char(code):
+    ch = chr(code)
+    return ch if ch.isprintable() and ch not in '\\' else ' '
+
+
+def emit_font_c(out, name, height, glyphs, direct, ranges, fallback, rle,
+                pairs, source):
+    data, index = [], []
+    for g in glyphs:
+        inked = [j for j, r in enumerate(g.rows) if r]
+        top = inked[0] if inked else 0
+        nrows = inked[-1] - top + 1 if inked else 0
+        if len(data) > 0xFFFF:
+            sys.exit('fontgen: %s: glyph data exceeds 64 KiB' % name)
+        index.append((len(data), g.width, g.advance, top, nrows))
+        data.extend(encode_rows(g.width, g.rows[top:top + nrows], rle))
+
+    ident = 'kFONT_%s' % name
+    w = out.write
+    w('// Generated by tools/fontgen.py from %s - do not edit.\n' % source)
+    w('// %d glyphs, %d bytes of %s glyph data, %d bytes of index.\n\n'
+      % (len(glyphs), len(data), 'RLE' if rle else 'raw', len(index) * 6))
+    w('#include "tft_font.h"\n\n')
+
+    w('static const tft_glyph_t %s_GLYPH_[%d] =\n{\n' % (ident, len(glyphs)))
+    for g, (offset, width, advance, top, nrows) in zip(glyphs, index):
+        w('    { %5d, %2d, %2d, %2d, %2d },  // U+%04X %s\n'
+          % (offset, width, advance, top, nrows, g.code,
+             c_comment_char(g.code)))
+    w('};\n\n')
+
+    w('static const uint8_t %s_DATA_[%d] =\n{\n' % (ident, max(len(data), 1)))
+    for i in range(0, max(len(data), 1), 12):
+        chunk = data[i:i + 12] or [0]
+        w('    ' + ', '.join('0x%02x' % b for b in chunk) + ',\n')
+    w('};\n\n')
+
+    if ranges:
+        w('static const tft_font_range_t %s_RANGE_[%d] =\n{\n'
+          % (ident, len(ranges)))
+        for first, count, glyph in ranges:
+            w('    { 0x%04x, %3d, %4d },\n' % (first, count, glyph))
+        w('};\n\n')
+
+    if pairs:
+        w('static const uint32_t %s_KERN_PAIR_[%d] =\n{\n' % (ident, len(pairs)))
+        for i in range(0, len(pairs), 6):
+            chunk = pairs[i:i + 6]
+            w('    ' + ', '.join('0x%04x%04x' % (a, b) for a, b, _ in chunk)
+              + ',\n')
+        w('};\n\n')
+        w('static const int8_t %s_KERN_VALUE_[%d] =\n{\n' % (ident, len(pairs)))
+        for i in range(0, len(pairs), 16):
+            chunk = pairs[i:i + 16]
+            w('    ' + ', '.join('%d' % k for _, _, k in chunk) + ',\n')
+        w('};\n\n')
+
+    w('const tft_font_t %s =\n{\n' % ident)
+    w('    .mHeight = %d,\n' % height)
+    w('    .mFlags = %s,\n' % ('TFT_FONT_RLE' if rle else '0'))
+    w('    .mFirstChar = 0x%02x,\n' % (direct[0] if direct else 0))
+    w('    .mDirectCount = %d,\n'
+      % (direct[1] - direct[0] + 1 if direct else 0))
+    w('    .mGlyphCount = %d,\n' % len(glyphs))
+    w('    .mFallback = %s,\n' % ('TFT_FONT_NO_GLYPH' if fallback is None
+                                   else '%d' % fallback))
+    w('    .mpGlyph = %s_GLYPH_,\n' % ident)
+    w('    .mpData = %s_DATA_,\n' % ident)
+    if ranges:
+        w('    .mRangeCount = %d,\n' % len(ranges))
+        w('    .mpRange = %s_RANGE_,\n' % ident)
+    if pairs:
+        w('    .mKernCount = %d,\n' % len(pairs))
+        w('    .mpKernPair = %s_KERN_PAIR_,\n' % ident)
+        w('    .mpKernValue = %s_KERN_VALUE_\n' % ident)
+    else:
+        w('    .mKernCount = 0\n')
+    w('};\n')
+
+    return len(data), len(index) * 6
+
+
+def parse_range(text):
+    if text == 'none':
+        return None
+    first, _, last = text.partition('-')
+    return int(first, 0), int(last or first, 0)
+
+
+def parse_codepoints(text):
+    if text == 'all':
+        return 'all'
+    codes = []
+    for item in text.split(','):
+        if item:
+            first, last = parse_range(item)
+            codes.extend(range(first, last + 1))
+    return codes
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Font table generator.')
+    ap.add_argument('source', nargs='+', help='font_8x8.h or BDF font(s)')
+    ap.add_argument('-o', '--output', required=True, help='output C file')
+    ap.add_argument('--name', required=True,
+                    help='font name, the object is kFONT_<name>')
+    ap.add_argument('--range', default='0x20-0x7e', type=parse_range,
+                    help='directly indexed codepoint range or `none` '
+                         '(default 0x20-0x7e)')
+    ap.add_argument('--extra', default='', type=parse_codepoints,
+                    help='comma separated codepoints or ranges indexed by '
+                         'the range table, or `all` glyphs of the source')
+    ap.add_argument('--fallback', type=lambda v: int(v, 0),
+                    help='codepoint of the glyph drawn for absent ones')
+    ap.add_argument('--rle', action='store_true',
+                    help='run-length encode glyph rows')
+    ap.add_argument('--spacing', type=int, default=1,
+                    help='blank columns after font_8x8.h glyphs (default 1)')
+    ap.add_argument('--no-kerning', action='store_true',
+                    help='do not emit kerning pairs')
+    ap.add_argument('--kern-set', default=DEFAULT_KERN_SET,
+                    help='characters considered for kerning')
+    args = ap.parse_args()
+
+    height, glyphs = None, []
+    for source in args.source:
+        if source.lower().endswith('.bdf'):
+            src_height, src_glyphs = parse_bdf(source)
+        else:
+            src_height, src_glyphs = parse_font_8x8(source, args.spacing)
+        if height is not None and src_height != height:
+            sys.exit('fontgen: %s: height %d differs from %d'
+                     % (source, src_height, height))
+        height = src_height
+        present = set(g.code for g in glyphs)
+        glyphs.extend(g for g in src_glyphs if g.code not in present)
+    if height > 255:
+        sys.exit('fontgen: %s: font is too high' % args.source[0])
+
+    extra = list(args.extra) if args.extra != 'all' else 'all'
+    if args.fallback is not None and extra != 'all':
+        extra.append(args.fallback)
+    glyphs, ranges = select_glyphs(glyphs, args.range, extra)
+
+    fallback = None
+    if args.fallback is not None:
+        fallback = [g.code for g in glyphs].index(args.fallback)
+
+    pairs = [] if args.no_kerning else compute_kerning(glyphs, args.kern_set)
+
+    with open(args.output, 'w', encoding='utf-8', newline='\n') as out:
+        emit_font_c(out, args.name, height, glyphs, args.range, ranges,
+                    fallback, args.rle, pairs,
+                    ', '.join(os.path.basename(f) for f in args.source))
+
+
+if __name__ == '__main__':
+    main()